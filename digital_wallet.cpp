@@ -7,6 +7,18 @@
 #include <ctime>
 #include <cstdlib>
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <cctype>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <stdexcept>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -14,6 +26,9 @@
 #else
     #include <dirent.h>
     #include <sys/stat.h>
+    #include <sys/file.h>
+    #include <fcntl.h>
+    #include <unistd.h>
 #endif
 
 using namespace std;
@@ -21,14 +36,43 @@ using namespace std;
 // Simple utility functions
 class Utils {
 public:
-    static string getCurrentTimestamp() {
-        time_t now = time(0);
-        char* timeStr = ctime(&now);
-        string result(timeStr);
-        result.pop_back(); // Remove newline
+    // Thread-safe localtime
+    static tm localTime(time_t t) {
+        tm result;
+        #ifdef _WIN32
+            localtime_s(&result, &t);
+        #else
+            localtime_r(&t, &result);
+        #endif
         return result;
     }
 
+    // Same format as ctime(), but safe to call from worker threads
+    static string getCurrentTimestamp() {
+        tm now = localTime(time(0));
+        char timeStr[32];
+        strftime(timeStr, sizeof(timeStr), "%a %b %e %H:%M:%S %Y", &now);
+        return timeStr;
+    }
+
+    static string formatTime(long long t) {
+        tm value = localTime((time_t)t);
+        char timeStr[32];
+        strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M", &value);
+        return timeStr;
+    }
+
+    static vector<string> split(string line, char delimiter) {
+        vector<string> parts;
+        size_t pos = 0;
+        while ((pos = line.find(delimiter)) != string::npos) {
+            parts.push_back(line.substr(0, pos));
+            line.erase(0, pos + 1);
+        }
+        parts.push_back(line);
+        return parts;
+    }
+
     static string formatCurrency(double amount) {
         return "Rs." + to_string((int)amount) + "." +
                (((int)(amount * 100)) % 100 < 10 ? "0" : "") +
@@ -49,10 +93,39 @@ public:
         cin.get();
     }
 
+    // Random number in [0, bound) from a per-thread engine, so worker
+    // threads neither race on nor contend for rand()'s shared state
+    static int randomInt(int bound) {
+        static thread_local mt19937 engine((unsigned)time(0) ^
+                                           (unsigned)hash<thread::id>()(this_thread::get_id()));
+        return (int)(engine() % (unsigned)bound);
+    }
+
     static int generateOTP() {
         return 1000 + (rand() % 9000); // 4-digit OTP
     }
 
+    // Create a directory (if missing) and make it the working directory
+    static bool enterDirectory(string path) {
+        #ifdef _WIN32
+            _mkdir(path.c_str());
+            return _chdir(path.c_str()) == 0;
+        #else
+            mkdir(path.c_str(), 0755);
+            return chdir(path.c_str()) == 0;
+        #endif
+    }
+
+    // Return to the parent directory and remove the (empty) directory left
+    static void leaveDirectory(string path) {
+        #ifdef _WIN32
+            _chdir("..");
+            _rmdir(path.c_str());
+        #else
+            if (chdir("..") == 0) rmdir(path.c_str());
+        #endif
+    }
+
     // Get list of files in current directory
     static vector<string> listFiles(string extension = "") {
         vector<string> files;
@@ -104,10 +177,17 @@ struct Transaction {
     Transaction(string t, double amt, string desc, double bal)
         : type(t), amount(amt), description(desc), balanceAfter(bal) {
         timestamp = Utils::getCurrentTimestamp();
-        id = "TXN" + to_string(rand() % 10000);
+        id = "TXN" + to_string(Utils::randomInt(10000));
     }
 };
 
+// Signed balance change (in paise) produced by a batch job
+struct Posting {
+    string type;
+    long long paise;
+    string description;
+};
+
 // Account class
 class Account {
 private:
@@ -115,6 +195,21 @@ private:
     string userId;
     double balance;
     vector<Transaction> transactions;
+    unordered_set<string> outReferences; // References of outgoing transfers
+    unordered_set<string> inReferences;  // References of incoming transfers
+
+    // Referenced transfer descriptions end in " [<reference>]"
+    void indexReference(const Transaction& txn) {
+        bool outgoing = txn.type == "TRANSFER_OUT";
+        if (!outgoing && txn.type != "TRANSFER_IN") return;
+
+        const string& desc = txn.description;
+        size_t open = desc.rfind(" [");
+        if (open == string::npos || desc.empty() || desc.back() != ']') return;
+
+        string reference = desc.substr(open + 2, desc.size() - open - 3);
+        (outgoing ? outReferences : inReferences).insert(reference);
+    }
 
 public:
     Account(string uid) : userId(uid), balance(0.0) {
@@ -143,24 +238,66 @@ public:
         return true;
     }
 
-    bool transfer(double amount, string toAccount) {
+    // An optional reference (e.g. a scheduled payment occurrence) is kept in
+    // the description so a replayed transfer can be recognised
+    static string transferOutDescription(string toAccount, string reference = "") {
+        return "Transfer to " + toAccount + (reference.empty() ? "" : " [" + reference + "]");
+    }
+
+    static string transferInDescription(string fromAccount, string reference = "") {
+        return "Transfer from " + fromAccount + (reference.empty() ? "" : " [" + reference + "]");
+    }
+
+    bool transfer(double amount, string toAccount, string reference = "") {
         if (amount <= 0 || amount > balance) return false;
 
         balance -= amount;
         transactions.push_back(Transaction("TRANSFER_OUT", amount,
-                                         "Transfer to " + toAccount, balance));
+                                         transferOutDescription(toAccount, reference), balance));
+        if (!reference.empty()) outReferences.insert(reference);
         return true;
     }
 
-    bool receiveTransfer(double amount, string fromAccount) {
+    bool receiveTransfer(double amount, string fromAccount, string reference = "") {
         if (amount <= 0) return false;
 
         balance += amount;
         transactions.push_back(Transaction("TRANSFER_IN", amount,
-                                         "Transfer from " + fromAccount, balance));
+                                         transferInDescription(fromAccount, reference), balance));
+        if (!reference.empty()) inReferences.insert(reference);
         return true;
     }
 
+    // Append pre-computed postings in bulk; amounts are exact paise
+    void applyPostings(const vector<Posting>& postings) {
+        if (postings.empty()) return;
+
+        long long balancePaise = llround(balance * 100);
+        transactions.reserve(transactions.size() + postings.size());
+        for (const Posting& posting : postings) {
+            balancePaise += posting.paise;
+            transactions.push_back(Transaction(posting.type, llabs(posting.paise) / 100.0,
+                                               posting.description, balancePaise / 100.0));
+        }
+        balance = balancePaise / 100.0;
+    }
+
+    // O(1) checks for a transfer made with the given reference
+    bool hasTransferOut(const string& reference) const {
+        return outReferences.count(reference) > 0;
+    }
+
+    bool hasTransferIn(const string& reference) const {
+        return inReferences.count(reference) > 0;
+    }
+
+    bool hasTransaction(const string& description) const {
+        for (auto it = transactions.rbegin(); it != transactions.rend(); ++it) {
+            if (it->description == description) return true;
+        }
+        return false;
+    }
+
     void showTransactions(int limit = 10) const {
         cout << "\n[Recent Transactions]\n";
         cout << string(70, '-') << "\n";
@@ -185,6 +322,7 @@ public:
         string filename = accountId + ".txt";
         ofstream file(filename);
         if (file.is_open()) {
+            file << fixed << setprecision(2); // Exact paise, not 6 significant digits
             file << accountId << "\n" << userId << "\n" << balance << "\n";
             file << transactions.size() << "\n";
             for (const auto& txn : transactions) {
@@ -210,6 +348,8 @@ public:
         file.ignore(); // Skip newline
 
         transactions.clear();
+        outReferences.clear();
+        inReferences.clear();
         for (int i = 0; i < txnCount; i++) {
             getline(file, line);
             // Parse transaction line
@@ -226,6 +366,7 @@ public:
                 txn.id = parts[0];
                 txn.timestamp = parts[4];
                 transactions.push_back(txn);
+                indexReference(txn);
             }
         }
         file.close();
@@ -299,21 +440,977 @@ public:
     }
 };
 
+// Change feed event types
+enum FeedEventType {
+    FEED_DEPOSIT = 1,
+    FEED_WITHDRAWAL = 2,
+    FEED_TRANSFER = 3,
+    FEED_INTEREST = 4,
+    FEED_FEE = 5
+};
+
+// A single committed wallet operation as seen by feed consumers
+struct FeedEvent {
+    uint64_t sequence;
+    int64_t timestamp;
+    uint8_t type;
+    int64_t amountPaise;
+    string fromAccount;
+    string toAccount;
+};
+
+// Change-data-capture feed of committed operations.
+// Events are appended as compact binary records to segment files named
+// wallet_feed_<first sequence>.bin, so consumers can tail the feed from a
+// saved sequence number instead of re-reading every account file.
+//
+// Durability: interactive deposits, withdrawals and transfers flush right
+// after their account files are saved, costing one small append per
+// operation. Batch jobs (scheduled payments, accrual) buffer their events
+// and flush once per batch, so a crash mid-batch can lose the buffered
+// events of that batch. The buffer is flushed early at 64 KB to bound memory.
+//
+// Record layout (little-endian):
+//   u32 length | u64 sequence | i64 timestamp | u8 type | i64 amount (paise)
+//   | u16 len + from account | u16 len + to account
+class ChangeFeed {
+private:
+    static const size_t SEGMENT_BYTES = 4 * 1024 * 1024;   // Roll segments at 4 MB
+    static const size_t RETAINED_BYTES = 64 * 1024 * 1024; // Retention: newest 64 MB
+    static const size_t MAX_PENDING_BYTES = 64 * 1024;     // Flush large batches early
+
+    ofstream segment;
+    size_t segmentSize;
+    uint64_t nextSequence;
+    uint64_t pendingFirstSequence;
+    string pending;
+
+    static void putInt(string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back((char)((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    static uint64_t getInt(const string& in, size_t& pos, int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= (uint64_t)(unsigned char)in[pos++] << (8 * i);
+        }
+        return value;
+    }
+
+    static void putString(string& out, const string& s) {
+        size_t len = min(s.size(), (size_t)0xFFFF);
+        putInt(out, len, 2);
+        out.append(s, 0, len);
+    }
+
+    static bool getString(const string& in, size_t& pos, string& s) {
+        if (pos + 2 > in.size()) return false;
+        size_t len = getInt(in, pos, 2);
+        if (pos + len > in.size()) return false;
+        s = in.substr(pos, len);
+        pos += len;
+        return true;
+    }
+
+    static string segmentName(uint64_t firstSequence) {
+        char name[64];
+        snprintf(name, sizeof(name), "wallet_feed_%020llu.bin",
+                 (unsigned long long)firstSequence);
+        return name;
+    }
+
+    // Segment files sorted oldest first (zero-padded names sort by sequence)
+    static vector<string> listSegments() {
+        vector<string> segments;
+        for (const string& filename : Utils::listFiles("wallet_feed_")) {
+            if (filename.size() == segmentName(0).size() &&
+                filename.compare(0, 12, "wallet_feed_") == 0 &&
+                filename.compare(filename.size() - 4, 4, ".bin") == 0) {
+                segments.push_back(filename);
+            }
+        }
+        sort(segments.begin(), segments.end());
+        return segments;
+    }
+
+    static uint64_t segmentFirstSequence(const string& filename) {
+        return strtoull(filename.substr(12, 20).c_str(), nullptr, 10);
+    }
+
+    static size_t fileSize(const string& filename) {
+        ifstream file(filename, ios::binary | ios::ate);
+        return file.is_open() ? (size_t)file.tellg() : 0;
+    }
+
+    // Cut a torn tail record off a segment by rewriting its good prefix
+    static void truncateSegment(const string& filename, size_t validBytes) {
+        string data(validBytes, '\0');
+        ifstream in(filename, ios::binary);
+        in.read(&data[0], validBytes);
+        in.close();
+
+        string tempName = filename + ".tmp";
+        ofstream out(tempName, ios::binary | ios::trunc);
+        out.write(data.data(), data.size());
+        out.close();
+
+        #ifdef _WIN32
+            remove(filename.c_str()); // rename() does not replace on Windows
+        #endif
+        rename(tempName.c_str(), filename.c_str());
+    }
+
+    // Read whole records from a segment, stopping at a torn or corrupt
+    // record. validBytes is set to the offset just past the last good record.
+    // Returns false if the segment could not be opened (e.g. just pruned).
+    static bool readSegment(const string& filename, uint64_t fromSequence,
+                            vector<FeedEvent>& out, size_t maxEvents, size_t& validBytes) {
+        validBytes = 0;
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) return false;
+
+        string header(4, '\0'), body;
+        while (out.size() < maxEvents && file.read(&header[0], 4)) {
+            size_t pos = 0;
+            size_t length = getInt(header, pos, 4);
+            if (length < 25 || length > SEGMENT_BYTES) break; // Corrupt header
+            body.resize(length);
+            if (!file.read(&body[0], length)) break;
+
+            FeedEvent event;
+            pos = 0;
+            event.sequence = getInt(body, pos, 8);
+            event.timestamp = (int64_t)getInt(body, pos, 8);
+            event.type = (uint8_t)getInt(body, pos, 1);
+            event.amountPaise = (int64_t)getInt(body, pos, 8);
+            if (!getString(body, pos, event.fromAccount) ||
+                !getString(body, pos, event.toAccount)) break;
+
+            if (event.sequence >= fromSequence) {
+                out.push_back(event);
+            }
+            validBytes += 4 + length;
+        }
+        return true;
+    }
+
+    void emit(FeedEventType type, const string& from, const string& to, double amount) {
+        string body;
+        putInt(body, nextSequence, 8);
+        putInt(body, (uint64_t)(int64_t)time(0), 8);
+        putInt(body, type, 1);
+        putInt(body, (uint64_t)(int64_t)llround(amount * 100), 8);
+        putString(body, from);
+        putString(body, to);
+
+        if (pending.empty()) pendingFirstSequence = nextSequence;
+        putInt(pending, body.size(), 4);
+        pending += body;
+        nextSequence++;
+
+        // Never let unflushed events grow without bound
+        if (pending.size() >= MAX_PENDING_BYTES) flush();
+    }
+
+    void rollSegment() {
+        if (segment.is_open()) segment.close();
+        segment.open(segmentName(pendingFirstSequence), ios::binary | ios::app);
+        segmentSize = 0;
+
+        // Drop the oldest segments once the feed exceeds its retained size
+        vector<string> segments = listSegments();
+        vector<size_t> sizes;
+        size_t totalBytes = 0;
+        for (const string& name : segments) {
+            sizes.push_back(fileSize(name));
+            totalBytes += sizes.back();
+        }
+        for (size_t i = 0; i + 1 < segments.size() && totalBytes > RETAINED_BYTES; i++) {
+            remove(segments[i].c_str());
+            totalBytes -= sizes[i];
+        }
+    }
+
+public:
+    ChangeFeed() : segmentSize(0), nextSequence(1), pendingFirstSequence(1) {
+        // Recover the sequence from the newest segment, cut off any record
+        // torn by a crash, and keep appending to that segment
+        vector<string> segments = listSegments();
+        if (!segments.empty()) {
+            const string& newest = segments.back();
+            vector<FeedEvent> events;
+            size_t validBytes;
+            readSegment(newest, 0, events, (size_t)-1, validBytes);
+            nextSequence = events.empty() ? segmentFirstSequence(newest)
+                                          : events.back().sequence + 1;
+
+            if (validBytes < fileSize(newest)) truncateSegment(newest, validBytes);
+            segment.open(newest, ios::binary | ios::app);
+            segmentSize = validBytes;
+        }
+    }
+
+    ~ChangeFeed() {
+        flush();
+    }
+
+    void recordDeposit(const string& accountId, double amount) {
+        emit(FEED_DEPOSIT, "", accountId, amount);
+    }
+
+    void recordWithdrawal(const string& accountId, double amount) {
+        emit(FEED_WITHDRAWAL, accountId, "", amount);
+    }
+
+    void recordTransfer(const string& fromAccount, const string& toAccount, double amount) {
+        emit(FEED_TRANSFER, fromAccount, toAccount, amount);
+    }
+
+    void recordInterest(const string& accountId, double amount) {
+        emit(FEED_INTEREST, "", accountId, amount);
+    }
+
+    void recordFee(const string& accountId, double amount) {
+        emit(FEED_FEE, accountId, "", amount);
+    }
+
+    // Append buffered events to the current segment
+    void flush() {
+        if (pending.empty()) return;
+
+        if (!segment.is_open() || segmentSize + pending.size() > SEGMENT_BYTES) {
+            rollSegment();
+        }
+        segment.write(pending.data(), pending.size());
+        segment.flush();
+        segmentSize += pending.size();
+        pending.clear();
+    }
+
+    // Oldest sequence still retained (sequences start at 1)
+    static uint64_t oldestSequence() {
+        vector<string> segments = listSegments();
+        return segments.empty() ? 1 : segmentFirstSequence(segments.front());
+    }
+
+    // Read up to maxEvents events starting at the given sequence number.
+    // Consumers persist (last sequence + 1) as their offset for the next call.
+    // Returns false, reading nothing, if retention has already deleted events
+    // from that offset, including segments pruned while this read runs; the
+    // consumer must resynchronise from oldestSequence().
+    static bool readFrom(uint64_t fromSequence, vector<FeedEvent>& out,
+                         size_t maxEvents = 1000) {
+        vector<string> segments = listSegments();
+        if (!segments.empty() && fromSequence < segmentFirstSequence(segments.front())) {
+            return false;
+        }
+
+        // Skip segments that end before the requested sequence
+        size_t start = 0;
+        for (size_t i = 1; i < segments.size(); i++) {
+            if (segmentFirstSequence(segments[i]) <= fromSequence) start = i;
+        }
+
+        size_t initialSize = out.size();
+        size_t validBytes;
+        for (size_t i = start; i < segments.size() && out.size() < maxEvents; i++) {
+            if (!readSegment(segments[i], fromSequence, out, maxEvents, validBytes)) {
+                out.resize(initialSize); // Never hand back events across a gap
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static string typeName(uint8_t type) {
+        switch (type) {
+            case FEED_DEPOSIT: return "DEPOSIT";
+            case FEED_WITHDRAWAL: return "WITHDRAWAL";
+            case FEED_TRANSFER: return "TRANSFER";
+            case FEED_INTEREST: return "INTEREST";
+            case FEED_FEE: return "FEE";
+            default: return "UNKNOWN";
+        }
+    }
+};
+
+// Hierarchical timing wheel with one-second ticks.
+// Four levels of 256 slots cover 2^32 seconds. Timers cascade down one level
+// each time the level below wraps, so advancing costs O(1) per tick no matter
+// how many timers are pending.
+class TimerWheel {
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const long long SLOT_MASK = SLOTS - 1;
+
+    struct Entry {
+        size_t id;
+        long long when;
+    };
+
+    vector<Entry> slots[LEVELS][SLOTS];
+    vector<size_t> expired; // Timers that were already due when scheduled
+    long long current;      // Next tick to process
+    size_t pending;
+
+    void place(const Entry& entry) {
+        long long delta = entry.when - current;
+        long long slotTime = entry.when;
+        long long horizon = 1LL << (SLOT_BITS * LEVELS);
+        if (delta >= horizon) slotTime = current + horizon - 1; // Re-placed on cascade
+
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1LL << (SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+        slots[level][(slotTime >> (SLOT_BITS * level)) & SLOT_MASK].push_back(entry);
+    }
+
+    void cascade(int level) {
+        vector<Entry> moved;
+        moved.swap(slots[level][(current >> (SLOT_BITS * level)) & SLOT_MASK]);
+        for (const Entry& entry : moved) {
+            place(entry);
+        }
+    }
+
+public:
+    TimerWheel() : current(0), pending(0) {}
+
+    void reset(long long now) {
+        for (int level = 0; level < LEVELS; level++) {
+            for (int slot = 0; slot < SLOTS; slot++) {
+                slots[level][slot].clear();
+            }
+        }
+        expired.clear();
+        current = now;
+        pending = 0;
+    }
+
+    void schedule(size_t id, long long when) {
+        if (when < current) {
+            expired.push_back(id);
+            return;
+        }
+        Entry entry = { id, when };
+        place(entry);
+        pending++;
+    }
+
+    // Collect every timer due at or before 'now'
+    void advance(long long now, vector<size_t>& due) {
+        due.insert(due.end(), expired.begin(), expired.end());
+        expired.clear();
+
+        while (current <= now && pending > 0) {
+            if ((current & SLOT_MASK) == 0) {
+                // Cascade top-down from the highest level that just wrapped
+                int top = 1;
+                while (top < LEVELS - 1 && ((current >> (SLOT_BITS * top)) & SLOT_MASK) == 0) {
+                    top++;
+                }
+                for (int level = top; level >= 1; level--) {
+                    cascade(level);
+                }
+            }
+
+            vector<Entry>& slot = slots[0][current & SLOT_MASK];
+            for (const Entry& entry : slot) {
+                due.push_back(entry.id);
+            }
+            pending -= slot.size();
+            slot.clear();
+            current++;
+        }
+
+        // Nothing pending: jump straight to 'now' instead of ticking
+        if (current <= now) current = now + 1;
+    }
+};
+
+// Standing order frequencies
+enum PaymentFrequency {
+    FREQ_ONCE = 0,
+    FREQ_DAILY = 1,
+    FREQ_WEEKLY = 2,
+    FREQ_MONTHLY = 3
+};
+
+// Scheduled payment (standing order) between two users
+struct ScheduledPayment {
+    string id;
+    string fromUser;
+    string toUser;
+    double amount;
+    int frequency;
+    int dayOfMonth;    // Anchor day for monthly payments
+    long long dueAt;   // Current calendar occurrence
+    long long nextRun; // Next attempt (after dueAt while retrying)
+    int retries;
+    string status;     // ACTIVE, COMPLETED, CANCELLED or FAILED
+};
+
+// Scheduled and recurring payments engine.
+// Due payments are executed in batches through Account::transfer and
+// Account::receiveTransfer. Each batch runs in two parallel phases: senders
+// are debited with accounts sharded across threads by sender, then
+// recipients are credited sharded by recipient, so no account is ever
+// touched by two threads at once.
+class PaymentScheduler {
+private:
+    static const int MAX_RETRIES = 3;
+    static const long long RETRY_DELAY = 3600;       // Doubles on each retry
+    static const size_t PARALLEL_THRESHOLD = 4096;   // Smaller batches run inline
+
+    string filename;
+    vector<ScheduledPayment> payments;
+    TimerWheel wheel;
+
+    static int daysInMonth(int year, int month) {
+        static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return (month == 1 && leap) ? 29 : days[month];
+    }
+
+    static long long nextOccurrence(const ScheduledPayment& payment) {
+        tm next = Utils::localTime((time_t)payment.dueAt);
+        switch (payment.frequency) {
+            case FREQ_DAILY: next.tm_mday += 1; break;
+            case FREQ_WEEKLY: next.tm_mday += 7; break;
+            case FREQ_MONTHLY:
+                // Normalise to the 1st of next month, then clamp the anchor day
+                next.tm_mday = 1;
+                next.tm_mon += 1;
+                next.tm_isdst = -1;
+                mktime(&next);
+                next.tm_mday = min(payment.dayOfMonth,
+                                   daysInMonth(next.tm_year + 1900, next.tm_mon));
+                break;
+            default: return -1;
+        }
+        next.tm_isdst = -1;
+        return mktime(&next);
+    }
+
+    // Move a payment past its current occurrence (paid or out of retries)
+    static void advanceOccurrence(ScheduledPayment& payment) {
+        payment.retries = 0;
+        if (payment.frequency == FREQ_ONCE) {
+            payment.status = "COMPLETED";
+            return;
+        }
+
+        long long next = nextOccurrence(payment);
+        if (next <= payment.dueAt) {
+            payment.status = "FAILED";
+            return;
+        }
+        payment.dueAt = next;
+        payment.nextRun = next;
+    }
+
+    // Identifies one occurrence of a payment; retries share the reference
+    static string occurrenceReference(const ScheduledPayment& payment) {
+        return payment.id + "@" + to_string(payment.dueAt);
+    }
+
+    static size_t shardOf(const Account* account, size_t shards) {
+        uint64_t h = (uint64_t)(uintptr_t)account;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return (size_t)(h % shards);
+    }
+
+    // Run work(i) for every index, partitioned so that all indices sharing an
+    // account in 'keys' run on the same thread
+    static void runSharded(const vector<Account*>& keys, const function<void(size_t)>& work) {
+        size_t workers = thread::hardware_concurrency();
+        if (workers == 0 || keys.size() < PARALLEL_THRESHOLD) workers = 1;
+
+        if (workers == 1) {
+            for (size_t i = 0; i < keys.size(); i++) work(i);
+            return;
+        }
+
+        vector<vector<size_t>> shards(workers);
+        for (size_t i = 0; i < keys.size(); i++) {
+            shards[shardOf(keys[i], workers)].push_back(i);
+        }
+
+        vector<thread> threads;
+        for (size_t w = 1; w < workers; w++) {
+            threads.emplace_back([&shards, &work, w]() {
+                for (size_t i : shards[w]) work(i);
+            });
+        }
+        for (size_t i : shards[0]) work(i);
+        for (thread& t : threads) t.join();
+    }
+
+    // Outcome bits per payment in a batch
+    static const char PAID = 1;       // Occurrence is debited (now or earlier)
+    static const char NEW_DEBIT = 2;  // Debit applied by this run
+    static const char NEW_CREDIT = 4; // Credit applied by this run
+
+    void executeBatch(const vector<size_t>& due, const vector<Account*>& from,
+                      const vector<Account*>& to, vector<char>& outcome) {
+        outcome.assign(due.size(), 0);
+
+        // Phase 1: debit senders. An occurrence whose debit was saved before
+        // a crash (but not the schedule file) is found in the sender's
+        // reference index and not charged again.
+        runSharded(from, [&](size_t i) {
+            const ScheduledPayment& payment = payments[due[i]];
+            string reference = occurrenceReference(payment);
+            if (from[i]->hasTransferOut(reference)) {
+                outcome[i] = PAID;
+            } else if (from[i]->transfer(payment.amount, to[i]->getAccountId(), reference)) {
+                outcome[i] = PAID | NEW_DEBIT;
+            }
+        });
+
+        // Phase 2: credit recipients of successful debits, skipping credits
+        // already saved by an interrupted run
+        runSharded(to, [&](size_t i) {
+            if (!(outcome[i] & PAID)) return;
+
+            const ScheduledPayment& payment = payments[due[i]];
+            string reference = occurrenceReference(payment);
+            if (!to[i]->hasTransferIn(reference)) {
+                to[i]->receiveTransfer(payment.amount, from[i]->getAccountId(), reference);
+                outcome[i] |= NEW_CREDIT;
+            }
+        });
+    }
+
+public:
+    // An empty filename keeps schedules in memory only
+    PaymentScheduler(string file = "") : filename(file) {
+        wheel.reset(time(0));
+        if (!filename.empty()) loadFromFile();
+    }
+
+    // dayOfMonth anchors monthly payments; 0 takes the day of firstRun
+    string addPayment(string fromUser, string toUser, double amount,
+                      int frequency, long long firstRun, int dayOfMonth = 0) {
+        ScheduledPayment payment;
+        payment.id = "SCH" + to_string(payments.size() + 1);
+        payment.fromUser = fromUser;
+        payment.toUser = toUser;
+        payment.amount = amount;
+        payment.frequency = frequency;
+        payment.dayOfMonth = dayOfMonth > 0 ? dayOfMonth : Utils::localTime((time_t)firstRun).tm_mday;
+        payment.dueAt = firstRun;
+        payment.nextRun = firstRun;
+        payment.retries = 0;
+        payment.status = "ACTIVE";
+
+        payments.push_back(payment);
+        wheel.schedule(payments.size() - 1, firstRun);
+        return payment.id;
+    }
+
+    bool cancelPayment(string id, string fromUser) {
+        for (ScheduledPayment& payment : payments) {
+            if (payment.id == id && payment.fromUser == fromUser && payment.status == "ACTIVE") {
+                payment.status = "CANCELLED"; // Stale wheel entry is skipped when it fires
+                return true;
+            }
+        }
+        return false;
+    }
+
+    vector<const ScheduledPayment*> activePaymentsFrom(string fromUser) const {
+        vector<const ScheduledPayment*> result;
+        for (const ScheduledPayment& payment : payments) {
+            if (payment.fromUser == fromUser && payment.status == "ACTIVE") {
+                result.push_back(&payment);
+            }
+        }
+        return result;
+    }
+
+    struct RunResult {
+        size_t paid;     // Occurrences applied by this run
+        size_t failed;   // Attempts that found insufficient funds
+        size_t replayed; // Occurrences fully applied before a crash; no changes
+    };
+
+    // Execute every payment due at or before 'now'. Occurrences missed during
+    // downtime are caught up one pass at a time. onPaid is called on this
+    // thread for each occurrence this run changed balances for, so replays of
+    // already applied occurrences are never reported twice.
+    RunResult runDue(long long now, const function<Account*(const string&)>& resolve,
+                     const function<void(const ScheduledPayment&, Account*, Account*)>& onPaid) {
+        RunResult result = { 0, 0, 0 };
+        vector<size_t> due;
+        vector<Account*> from, to;
+        vector<char> outcome;
+
+        while (true) {
+            due.clear();
+            wheel.advance(now, due);
+            if (due.empty()) break;
+
+            // Resolve accounts, dropping cancelled payments and missing users
+            size_t kept = 0;
+            from.resize(due.size());
+            to.resize(due.size());
+            for (size_t i = 0; i < due.size(); i++) {
+                ScheduledPayment& payment = payments[due[i]];
+                if (payment.status != "ACTIVE") continue;
+
+                Account* src = resolve(payment.fromUser);
+                Account* dst = resolve(payment.toUser);
+                if (!src || !dst) {
+                    payment.status = "FAILED";
+                    continue;
+                }
+                due[kept] = due[i];
+                from[kept] = src;
+                to[kept] = dst;
+                kept++;
+            }
+            due.resize(kept);
+            from.resize(kept);
+            to.resize(kept);
+
+            executeBatch(due, from, to, outcome);
+
+            for (size_t i = 0; i < due.size(); i++) {
+                ScheduledPayment& payment = payments[due[i]];
+                if (outcome[i] & PAID) {
+                    if (outcome[i] & (NEW_DEBIT | NEW_CREDIT)) {
+                        onPaid(payment, from[i], to[i]);
+                        result.paid++;
+                    } else {
+                        result.replayed++;
+                    }
+                    advanceOccurrence(payment);
+                } else if (payment.retries < MAX_RETRIES) {
+                    // Insufficient funds: retry later with exponential backoff
+                    result.failed++;
+                    payment.nextRun = now + (RETRY_DELAY << payment.retries);
+                    payment.retries++;
+                } else {
+                    result.failed++;
+                    advanceOccurrence(payment); // Skip this occurrence
+                }
+
+                if (payment.status == "ACTIVE") {
+                    wheel.schedule(due[i], payment.nextRun);
+                }
+            }
+        }
+        return result;
+    }
+
+    void saveToFile() const {
+        if (filename.empty()) return;
+
+        ofstream file(filename);
+        if (file.is_open()) {
+            file << payments.size() << "\n";
+            for (const auto& p : payments) {
+                file << p.id << "|" << p.fromUser << "|" << p.toUser << "|"
+                     << fixed << setprecision(2) << p.amount << "|"
+                     << p.frequency << "|" << p.dayOfMonth << "|"
+                     << p.dueAt << "|" << p.nextRun << "|"
+                     << p.retries << "|" << p.status << "\n";
+            }
+            file.close();
+        }
+    }
+
+    bool loadFromFile() {
+        ifstream file(filename);
+        if (!file.is_open()) return false;
+
+        int count;
+        file >> count;
+        file.ignore(); // Skip newline
+
+        payments.clear();
+        string line;
+        for (int i = 0; i < count && getline(file, line); i++) {
+            vector<string> parts = Utils::split(line, '|');
+            if (parts.size() < 10) continue;
+
+            ScheduledPayment payment;
+            payment.id = parts[0];
+            payment.fromUser = parts[1];
+            payment.toUser = parts[2];
+            payment.amount = stod(parts[3]);
+            payment.frequency = stoi(parts[4]);
+            payment.dayOfMonth = stoi(parts[5]);
+            payment.dueAt = stoll(parts[6]);
+            payment.nextRun = stoll(parts[7]);
+            payment.retries = stoi(parts[8]);
+            payment.status = parts[9];
+
+            payments.push_back(payment);
+            if (payment.status == "ACTIVE") {
+                wheel.schedule(payments.size() - 1, payment.nextRun); // Past runs catch up
+            }
+        }
+        file.close();
+        return true;
+    }
+
+    // First run for a monthly payment on the given day (midnight), from now on
+    static long long firstMonthlyRun(int day, long long now) {
+        tm run = Utils::localTime((time_t)now);
+        for (int attempt = 0; attempt < 2; attempt++) {
+            run.tm_mday = min(day, daysInMonth(run.tm_year + 1900, run.tm_mon));
+            run.tm_hour = run.tm_min = run.tm_sec = 0;
+            run.tm_isdst = -1;
+            long long when = mktime(&run);
+            if (when >= now) return when;
+
+            run.tm_mday = 1;
+            run.tm_mon += 1;
+            run.tm_isdst = -1;
+            mktime(&run);
+        }
+        return now;
+    }
+
+    // Midnight 'days' days from now, or now itself when days is 0
+    static long long startInDays(int days, long long now) {
+        if (days <= 0) return now;
+        tm run = Utils::localTime((time_t)now);
+        run.tm_mday += days;
+        run.tm_hour = run.tm_min = run.tm_sec = 0;
+        run.tm_isdst = -1;
+        return mktime(&run);
+    }
+
+    static string frequencyName(int frequency) {
+        switch (frequency) {
+            case FREQ_ONCE: return "Once";
+            case FREQ_DAILY: return "Daily";
+            case FREQ_WEEKLY: return "Weekly";
+            case FREQ_MONTHLY: return "Monthly";
+            default: return "Unknown";
+        }
+    }
+};
+
+// Batch interest and fee accrual across all accounts.
+// Accounts are processed in chunks. Postings are computed in parallel with
+// exact integer arithmetic (paise and basis points), each changed account is
+// then written once, and the chunk's account IDs are appended to a checkpoint
+// file so an interrupted run resumes where it stopped.
+class AccrualJob {
+private:
+    static const size_t CHUNK_SIZE = 65536;
+    static const size_t PARALLEL_THRESHOLD = 1024; // Smaller chunks run inline
+
+    string jobId;
+    long long annualRateBps;
+    long long monthlyFeePaise;
+    bool persistent;
+
+    string checkpointFile() const { return "accrual_" + jobId + ".chk"; }
+
+    // Run work(begin, end) over contiguous ranges, one range per thread
+    static void parallelRanges(size_t count, const function<void(size_t, size_t)>& work) {
+        size_t workers = thread::hardware_concurrency();
+        if (workers == 0 || count < PARALLEL_THRESHOLD) workers = 1;
+        size_t perWorker = (count + workers - 1) / workers;
+
+        vector<thread> threads;
+        for (size_t begin = perWorker; begin < count; begin += perWorker) {
+            threads.emplace_back(work, begin, min(count, begin + perWorker));
+        }
+        work(0, min(count, perWorker));
+        for (thread& t : threads) t.join();
+    }
+
+    vector<Posting> computePostings(const Account* account) const {
+        vector<Posting> postings;
+        long long balancePaise = llround(account->getBalance() * 100);
+
+        if (balancePaise > 0 && annualRateBps > 0) {
+            // Monthly interest rounded half up: balance * bps / (10000 * 12)
+            long long interest = (balancePaise * annualRateBps + 60000) / 120000;
+            if (interest > 0) {
+                postings.push_back(Posting{ "INTEREST", interest, "Interest " + jobId });
+                balancePaise += interest;
+            }
+        }
+
+        long long fee = min(monthlyFeePaise, balancePaise); // Never overdraw
+        if (fee > 0) {
+            postings.push_back(Posting{ "FEE", -fee, "Fee " + jobId });
+        }
+        return postings;
+    }
+
+public:
+    // Job IDs end up in a file name and in '|'-delimited account files, so
+    // only [A-Za-z0-9_-] is allowed
+    static bool isValidJobId(const string& id) {
+        if (id.empty() || id.size() > 64) return false;
+        for (char c : id) {
+            if (!isalnum((unsigned char)c) && c != '_' && c != '-') return false;
+        }
+        return true;
+    }
+
+    struct Result {
+        size_t accrued;   // Accounts processed by this run
+        size_t skipped;   // Accounts already done by an earlier run
+        double seconds;
+    };
+
+    // A non-persistent job neither writes account files nor checkpoints
+    AccrualJob(string id, long long rateBps, long long feePaise, bool persist = true)
+        : jobId(id), annualRateBps(rateBps), monthlyFeePaise(feePaise), persistent(persist) {}
+
+    // onCommitted is called on this thread for each changed account once its
+    // chunk has been written
+    Result run(const vector<Account*>& accounts,
+               const function<void(const Account*, const vector<Posting>&)>& onCommitted) {
+        auto start = chrono::steady_clock::now();
+        Result result = { 0, 0, 0.0 };
+
+        // Resume: accounts recorded in the checkpoint are skipped cheaply.
+        // Every other account is also checked for this job's posting tags, so
+        // the job never posts twice, even if the checkpoint was lost or an
+        // account was written just before an interruption.
+        set<string> done;
+        if (persistent) {
+            ifstream in(checkpointFile());
+            string id;
+            while (getline(in, id)) done.insert(id);
+        }
+
+        ofstream checkpoint;
+        if (persistent) checkpoint.open(checkpointFile(), ios::app);
+
+        vector<vector<Posting>> postings;
+        vector<char> skipped;
+        size_t chunkSize = CHUNK_SIZE; // min() takes references; avoid ODR-using the member
+        for (size_t base = 0; base < accounts.size(); base += chunkSize) {
+            size_t count = min(chunkSize, accounts.size() - base);
+            postings.assign(count, vector<Posting>());
+            skipped.assign(count, 0);
+
+            // Compute and apply postings; each account belongs to one range
+            parallelRanges(count, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    Account* account = accounts[base + i];
+                    if (done.count(account->getAccountId()) ||
+                        account->hasTransaction("Interest " + jobId) ||
+                        account->hasTransaction("Fee " + jobId)) {
+                        skipped[i] = 1;
+                        continue;
+                    }
+                    postings[i] = computePostings(account);
+                    account->applyPostings(postings[i]);
+                }
+            });
+
+            // Coalesced write phase: each changed account is written once
+            if (persistent) {
+                parallelRanges(count, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        if (!postings[i].empty()) accounts[base + i]->saveToFile();
+                    }
+                });
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                if (skipped[i]) {
+                    result.skipped++;
+                    continue;
+                }
+                result.accrued++;
+                if (persistent) checkpoint << accounts[base + i]->getAccountId() << "\n";
+                if (onCommitted && !postings[i].empty()) onCommitted(accounts[base + i], postings[i]);
+            }
+            if (persistent) checkpoint.flush();
+        }
+
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return result;
+    }
+};
+
+// Exclusive lock on the data directory, held for the life of the process so
+// the interactive wallet and batch jobs never write the same files at once.
+// The OS releases it when the process exits, even after a crash.
+class ProcessLock {
+private:
+    #ifdef _WIN32
+        HANDLE handle;
+    #else
+        int fd;
+    #endif
+
+public:
+    ProcessLock(string filename) {
+        #ifdef _WIN32
+            // No sharing: a second open fails while this handle is held
+            handle = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                                 OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            bool locked = handle != INVALID_HANDLE_VALUE;
+        #else
+            fd = open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+            bool locked = fd >= 0 && flock(fd, LOCK_EX | LOCK_NB) == 0;
+            if (!locked && fd >= 0) close(fd);
+        #endif
+
+        if (!locked) {
+            throw runtime_error("Another wallet process is using this directory (" +
+                                filename + " is locked)");
+        }
+    }
+
+    ~ProcessLock() {
+        #ifdef _WIN32
+            CloseHandle(handle);
+        #else
+            close(fd);
+        #endif
+    }
+
+    ProcessLock(const ProcessLock&) = delete;
+    ProcessLock& operator=(const ProcessLock&) = delete;
+};
+
 // Main Wallet System
 class WalletSystem {
 private:
+    ProcessLock lock;           // Taken before the feed or any data file is opened
     vector<User*> users;
     User* currentUser;
     map<string, User*> userMap; // For quick lookup
+    ChangeFeed feed;            // CDC stream of committed operations
+    PaymentScheduler scheduler; // Standing orders
+    bool saveOnExit;
 
 public:
-    WalletSystem() : currentUser(nullptr) {
+    // Batch jobs pass catchUpPayments = false so they only touch what they own
+    explicit WalletSystem(bool catchUpPayments = true)
+        : lock("wallet.lock"), currentUser(nullptr), scheduler("scheduled_payments.txt"),
+          saveOnExit(true) {
         srand(time(0));
         loadUsersFromFiles();
+        if (catchUpPayments) {
+            processDuePayments(); // Catch up on payments missed while offline
+        }
     }
 
     ~WalletSystem() {
-        saveAllUsers();
+        if (saveOnExit) saveAllUsers();
         for (User* user : users) {
             delete user;
         }
@@ -322,6 +1419,7 @@ public:
     void run() {
         int choice;
         do {
+            processDuePayments();
             showMainMenu();
             cout << "Enter your choice: ";
             cin >> choice;
@@ -339,6 +1437,37 @@ public:
         } while (choice != 4);
     }
 
+    // Post monthly interest and fees to every account under a resumable job ID
+    void runAccrual(string jobId, long long annualRateBps, long long monthlyFeePaise) {
+        vector<Account*> accounts;
+        for (User* user : users) {
+            accounts.push_back(user->getAccount());
+        }
+
+        cout << "[Accrual] Running job " << jobId << " over " << accounts.size() << " account(s)...\n";
+
+        AccrualJob job(jobId, annualRateBps, monthlyFeePaise);
+        AccrualJob::Result result = job.run(accounts,
+            [this](const Account* account, const vector<Posting>& postings) {
+                for (const Posting& posting : postings) {
+                    if (posting.paise > 0) {
+                        feed.recordInterest(account->getAccountId(), posting.paise / 100.0);
+                    } else {
+                        feed.recordFee(account->getAccountId(), -posting.paise / 100.0);
+                    }
+                }
+            });
+        feed.flush();
+
+        // Changed accounts were already written once by the job
+        saveOnExit = false;
+
+        cout << "[Accrual] " << result.accrued << " account(s) accrued, " << result.skipped
+             << " already done, in " << fixed << setprecision(3) << result.seconds << " s ("
+             << setprecision(0) << (result.seconds > 0 ? result.accrued / result.seconds : 0)
+             << " accounts/sec)\n";
+    }
+
 private:
     void showMainMenu() {
         Utils::clearScreen();
@@ -429,6 +1558,7 @@ private:
     void userDashboard() {
         int choice;
         do {
+            processDuePayments();
             showUserDashboard();
             cout << "Enter your choice: ";
             cin >> choice;
@@ -439,16 +1569,17 @@ private:
                 case 3: withdrawMoney(); break;
                 case 4: transferMoney(); break;
                 case 5: viewTransactions(); break;
-                case 6:
+                case 6: scheduledPayments(); break;
+                case 7:
                     cout << "\nLogging out...\n";
                     currentUser = nullptr;
                     break;
                 default: cout << "\n[X] Invalid choice!\n";
             }
 
-            if (choice != 6) Utils::pause();
+            if (choice != 7) Utils::pause();
 
-        } while (choice != 6);
+        } while (choice != 7);
     }
 
     void showUserDashboard() {
@@ -468,7 +1599,8 @@ private:
         cout << "|  3. Withdraw Money                 |\n";
         cout << "|  4. Transfer Money                 |\n";
         cout << "|  5. View Transactions              |\n";
-        cout << "|  6. Logout                         |\n";
+        cout << "|  6. Scheduled Payments             |\n";
+        cout << "|  7. Logout                         |\n";
         cout << "+------------------------------------+\n\n";
     }
 
@@ -505,6 +1637,8 @@ private:
             cout << "New Balance: " << Utils::formatCurrency(acc->getBalance()) << "\n";
 
             currentUser->saveToFile();
+            feed.recordDeposit(acc->getAccountId(), amount);
+            feed.flush();
         } else {
             cout << "\n[X] Deposit failed!\n";
         }
@@ -545,6 +1679,8 @@ private:
             cout << "New Balance: " << Utils::formatCurrency(acc->getBalance()) << "\n";
 
             currentUser->saveToFile();
+            feed.recordWithdrawal(acc->getAccountId(), amount);
+            feed.flush();
         } else {
             cout << "\n[X] Insufficient balance!\n";
         }
@@ -619,6 +1755,8 @@ private:
             // Save both users
             currentUser->saveToFile();
             recipient->saveToFile();
+            feed.recordTransfer(senderAcc->getAccountId(), recipientAcc->getAccountId(), amount);
+            feed.flush();
 
             cout << "\n[SMS] SMS sent to " << recipient->getPhone()
                  << ": You received " << Utils::formatCurrency(amount)
@@ -637,6 +1775,161 @@ private:
         currentUser->getAccount()->showTransactions(15);
     }
 
+    void scheduledPayments() {
+        Utils::clearScreen();
+        cout << "\n[SCHEDULED PAYMENTS]\n";
+        cout << "====================\n\n";
+
+        vector<const ScheduledPayment*> active = scheduler.activePaymentsFrom(currentUser->getUsername());
+        if (active.empty()) {
+            cout << "No scheduled payments.\n";
+        } else {
+            cout << left << setw(10) << "ID" << setw(15) << "To" << setw(12) << "Amount"
+                 << setw(10) << "Repeat" << "Next Run\n";
+            cout << string(65, '-') << "\n";
+            for (const ScheduledPayment* payment : active) {
+                cout << left << setw(10) << payment->id << setw(15) << payment->toUser
+                     << setw(12) << Utils::formatCurrency(payment->amount)
+                     << setw(10) << PaymentScheduler::frequencyName(payment->frequency)
+                     << Utils::formatTime(payment->nextRun)
+                     << (payment->retries > 0 ? " (retry)" : "") << "\n";
+            }
+        }
+
+        cout << "\n1. Create Scheduled Payment\n";
+        cout << "2. Cancel Scheduled Payment\n";
+        cout << "3. Back\n";
+        cout << "\nEnter your choice: ";
+        int choice;
+        cin >> choice;
+
+        if (choice == 1) {
+            createScheduledPayment();
+        } else if (choice == 2) {
+            string id;
+            cout << "Enter payment ID to cancel: ";
+            cin >> id;
+
+            if (scheduler.cancelPayment(id, currentUser->getUsername())) {
+                scheduler.saveToFile();
+                cout << "\n[SUCCESS] Scheduled payment cancelled.\n";
+            } else {
+                cout << "\n[X] Scheduled payment not found!\n";
+            }
+        }
+    }
+
+    void createScheduledPayment() {
+        cout << "\nAvailable Recipients:\n";
+        vector<User*> recipients;
+        for (User* user : users) {
+            if (user != currentUser) {
+                recipients.push_back(user);
+                cout << recipients.size() << ". " << user->getFullName()
+                     << " (" << user->getUsername() << ")\n";
+            }
+        }
+
+        if (recipients.empty()) {
+            cout << "\n[X] No recipients available!\n";
+            return;
+        }
+
+        cout << "\nSelect recipient: ";
+        int choice;
+        cin >> choice;
+
+        if (choice < 1 || choice > (int)recipients.size()) {
+            cout << "\n[X] Invalid selection!\n";
+            return;
+        }
+        User* recipient = recipients[choice - 1];
+
+        double amount;
+        cout << "Enter amount: Rs.";
+        cin >> amount;
+
+        if (amount <= 0) {
+            cout << "\n[X] Invalid amount!\n";
+            return;
+        }
+
+        cout << "Repeat (1. Once  2. Daily  3. Weekly  4. Monthly): ";
+        int frequency;
+        cin >> frequency;
+
+        if (frequency < 1 || frequency > 4) {
+            cout << "\n[X] Invalid selection!\n";
+            return;
+        }
+        frequency -= 1;
+
+        long long now = time(0);
+        long long firstRun;
+        int day = 0;
+        if (frequency == FREQ_MONTHLY) {
+            cout << "Day of month (1-31): ";
+            cin >> day;
+
+            if (day < 1 || day > 31) {
+                cout << "\n[X] Invalid day!\n";
+                return;
+            }
+            firstRun = PaymentScheduler::firstMonthlyRun(day, now);
+        } else {
+            int days;
+            cout << "Start in how many days (0 = now): ";
+            cin >> days;
+            firstRun = PaymentScheduler::startInDays(days, now);
+        }
+
+        // OTP verification
+        int otp = Utils::generateOTP();
+        cout << "\n[OTP] OTP sent to " << currentUser->getPhone() << ": " << otp << "\n";
+        cout << "Enter OTP: ";
+        int enteredOTP;
+        cin >> enteredOTP;
+
+        if (enteredOTP != otp) {
+            cout << "\n[X] Invalid OTP!\n";
+            return;
+        }
+
+        string id = scheduler.addPayment(currentUser->getUsername(), recipient->getUsername(),
+                                         amount, frequency, firstRun, day);
+        scheduler.saveToFile();
+
+        cout << "\n[SUCCESS] Payment " << id << " scheduled!\n";
+        cout << "First Run: " << Utils::formatTime(firstRun) << "\n";
+    }
+
+    // Run due scheduled payments and commit each affected user once
+    void processDuePayments() {
+        set<User*> touched;
+        PaymentScheduler::RunResult result = scheduler.runDue(time(0),
+            [this](const string& username) -> Account* {
+                auto it = userMap.find(username);
+                return it == userMap.end() ? nullptr : it->second->getAccount();
+            },
+            [&](const ScheduledPayment& payment, Account* from, Account* to) {
+                touched.insert(userMap[payment.fromUser]);
+                touched.insert(userMap[payment.toUser]);
+                feed.recordTransfer(from->getAccountId(), to->getAccountId(), payment.amount);
+            });
+
+        if (result.paid == 0 && result.failed == 0 && result.replayed == 0) return;
+
+        for (User* user : touched) {
+            user->saveToFile();
+        }
+        feed.flush();
+        scheduler.saveToFile();
+
+        if (result.paid + result.failed > 0) {
+            cout << "[Scheduler] Processed " << result.paid + result.failed << " scheduled payment(s).\n";
+        }
+    }
+
     void showAbout() {
         Utils::clearScreen();
         cout << "\n+=======================================+\n";
@@ -650,6 +1943,7 @@ private:
         cout << "* Money Deposit & Withdrawal\n";
         cout << "* Fund Transfers\n";
         cout << "* Transaction History\n";
+        cout << "* Scheduled & Recurring Payments\n";
         cout << "* Basic OTP Security\n";
         cout << "* File-based Data Storage\n\n";
 
@@ -700,8 +1994,160 @@ private:
     }
 };
 
+// Print feed events from a saved offset: wallet --tail-feed <sequence>
+int tailFeed(uint64_t fromSequence) {
+    vector<FeedEvent> events;
+    if (!ChangeFeed::readFrom(fromSequence, events)) {
+        cout << "[Feed] Offset " << fromSequence << " has been pruned; oldest available is "
+             << ChangeFeed::oldestSequence() << "\n";
+        return 1;
+    }
+
+    for (const FeedEvent& event : events) {
+        cout << event.sequence << " " << event.timestamp << " "
+             << ChangeFeed::typeName(event.type) << " "
+             << Utils::formatCurrency(event.amountPaise / 100.0) << " "
+             << (event.fromAccount.empty() ? "-" : event.fromAccount) << " "
+             << (event.toAccount.empty() ? "-" : event.toAccount) << "\n";
+    }
+
+    uint64_t nextOffset = events.empty() ? fromSequence : events.back().sequence + 1;
+    cout << "[Feed] Next offset: " << nextOffset << "\n";
+    return 0;
+}
+
+// Fire N scheduled payments due at the same instant: wallet --bench-scheduler [N]
+int benchScheduler(size_t count) {
+    size_t accountCount = max((size_t)2, min(count, (size_t)200000));
+    size_t perAccount = (count + accountCount - 1) / accountCount;
+
+    cout << "[Bench] Creating " << accountCount << " accounts...\n";
+    vector<Account*> accounts;
+    unordered_map<string, Account*> byName;
+    for (size_t i = 0; i < accountCount; i++) {
+        Account* account = new Account("BENCH" + to_string(i));
+        account->deposit(perAccount * 10.0);
+        accounts.push_back(account);
+        byName["bench" + to_string(i)] = account;
+    }
+
+    // Everyone pays at the next midnight
+    long long now = time(0);
+    long long fireAt = PaymentScheduler::startInDays(1, now);
+
+    PaymentScheduler scheduler;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        scheduler.addPayment("bench" + to_string(i % accountCount),
+                             "bench" + to_string((i + 1) % accountCount),
+                             1.0, FREQ_MONTHLY, fireAt);
+    }
+    auto scheduled = chrono::steady_clock::now();
+
+    size_t paid = 0;
+    scheduler.runDue(fireAt,
+        [&byName](const string& username) -> Account* {
+            auto it = byName.find(username);
+            return it == byName.end() ? nullptr : it->second;
+        },
+        [&paid](const ScheduledPayment&, Account*, Account*) { paid++; });
+    auto finished = chrono::steady_clock::now();
+
+    double scheduleMs = chrono::duration<double, milli>(scheduled - start).count();
+    double runMs = chrono::duration<double, milli>(finished - scheduled).count();
+    cout << "[Bench] Scheduled " << count << " payments in " << fixed << setprecision(1)
+         << scheduleMs << " ms\n";
+    cout << "[Bench] Executed " << paid << " payments in " << runMs << " ms ("
+         << setprecision(0) << (runMs > 0 ? paid / (runMs / 1000.0) : 0)
+         << " payments/sec, " << max(1u, thread::hardware_concurrency()) << " threads)\n";
+
+    for (Account* account : accounts) {
+        delete account;
+    }
+    return paid == count ? 0 : 1;
+}
+
+// Accrue interest and fees over N accounts: wallet --bench-accrual [N] [--persist]
+// With --persist the job runs in a scratch directory, writing every account
+// file and the checkpoint exactly as --run-accrual does.
+int benchAccrual(size_t count, bool persist) {
+    const string scratchDir = "accrual_bench";
+    if (persist) {
+        if (!Utils::enterDirectory(scratchDir)) {
+            cout << "[X] Cannot use scratch directory " << scratchDir << "\n";
+            return 1;
+        }
+        remove("accrual_BENCH.chk"); // Left over from an interrupted benchmark
+    }
+
+    cout << "[Bench] Creating " << count << " accounts...\n";
+    vector<Account*> accounts;
+    accounts.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        Account* account = new Account("BENCH" + to_string(i));
+        account->deposit(1000 + (i % 100000) / 100.0);
+        accounts.push_back(account);
+    }
+
+    // 4% annual interest, Rs.5 monthly fee
+    AccrualJob job("BENCH", 400, 500, persist);
+    AccrualJob::Result result = job.run(accounts, nullptr);
+
+    cout << "[Bench] Accrued " << result.accrued << " accounts in " << fixed << setprecision(3)
+         << result.seconds << " s (" << setprecision(0)
+         << (result.seconds > 0 ? result.accrued / result.seconds : 0) << " accounts/sec, "
+         << max(1u, thread::hardware_concurrency()) << " threads)\n";
+    cout << (persist ? "[Bench] Includes one account file write per account and the checkpoint.\n"
+                     : "[Bench] Compute only: excludes file writes and checkpoint (use --persist).\n");
+
+    for (Account* account : accounts) {
+        if (persist) remove((account->getAccountId() + ".txt").c_str());
+        delete account;
+    }
+    if (persist) {
+        remove("accrual_BENCH.chk");
+        Utils::leaveDirectory(scratchDir);
+    }
+    return result.accrued == count ? 0 : 1;
+}
+
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "--tail-feed") {
+        return tailFeed(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 1);
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-scheduler") {
+        return benchScheduler(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 1000000);
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-accrual") {
+        size_t count = 1000000;
+        bool persist = false;
+        for (int i = 2; i < argc; i++) {
+            if (string(argv[i]) == "--persist") {
+                persist = true;
+            } else {
+                count = strtoull(argv[i], nullptr, 10);
+            }
+        }
+        return benchAccrual(count, persist);
+    }
+    if (argc >= 2 && string(argv[1]) == "--run-accrual") {
+        if (argc < 3 || !AccrualJob::isValidJobId(argv[2])) {
+            cout << "Usage: wallet --run-accrual <jobId> [annualRateBps] [monthlyFeePaise]\n";
+            cout << "       jobId: 1-64 characters from A-Z, a-z, 0-9, '_' and '-'\n";
+            return 1;
+        }
+        try {
+            WalletSystem wallet(false);
+            wallet.runAccrual(argv[2], argc >= 4 ? atoll(argv[3]) : 400,
+                              argc >= 5 ? atoll(argv[4]) : 0);
+        } catch (const exception& e) {
+            cout << "\n[X] System Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     cout << "Starting Digital Wallet System...\n\n";
 
     try {